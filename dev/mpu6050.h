@@ -43,9 +43,10 @@ enum MPU6050_IICAddress{
  * @brief  Basic configuration structure.
  */
 typedef struct{
-  IIC_Port_t   Port;         /*!< IIC pins for physical connection*/
-  uint16_t     Address;      /*!< 7 bits IIC address */
-  IIC_PullUp_t PullUpOption;
+  IIC_Port_t     Port;         /*!< IIC pins for physical connection*/
+  uint16_t       Address;      /*!< 7 bits IIC address */
+  IIC_PullUp_t   PullUpOption;
+  IIC_Priority_t Priority;     /*!< Priority on a shared IIC port */
 }MPU6050_Parameters_t;
 
 
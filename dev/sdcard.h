@@ -50,6 +50,10 @@ EStatus_t SDCARD_IntHwInit( void );
  * @retval EStatus_t
  *@note  This routine only configures the device hardware and is not enough
  *       for full device usage; the SDCARD_IntHwInit must be called first.
+ *       Identification runs with SDCARD_PRESCALER, below 400 kHz. Once it is
+ *       done, the maximum clock given by the TRAN_SPEED field of the card CSD
+ *       is read and SPI_SetPrescaler switches to the fastest prescaler that
+ *       does not exceed it, limited to SDCARD_DATA_PRESCALER.
  */
 EStatus_t SDCARD_ExtHwConfig( void );
 
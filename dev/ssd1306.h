@@ -53,9 +53,11 @@ enum SSD1306_IICAddress{
  * @brief  Basic configuration structure.
  */
 typedef struct{
-  IIC_Port_t   Port;         /*!< IIC pins for physical connection*/
-  uint16_t     Address;      /*!< 7 bits IIC address */
-  IIC_PullUp_t PullUpOption;
+  IIC_Port_t     Port;         /*!< IIC pins for physical connection*/
+  uint16_t       Address;      /*!< 7 bits IIC address */
+  IIC_PullUp_t   PullUpOption;
+  IIC_Priority_t Priority;     /*!< Priority on a shared IIC port */
+  uint16_t       MaxChunkSize; /*!< Bytes per display memory write chunk */
 }SSD1306_Parameters_t;
 
 
@@ -27,12 +27,51 @@
 #endif
 
 
+/**
+ * @brief Maximum number of sends that can wait in the transmission queue of
+ * each UART ID. UART_MAX_QUEUED_SENDS can be changed by defining it on setup.h
+ * file.
+ */
+#ifndef UART_MAX_QUEUED_SENDS
+#define UART_MAX_QUEUED_SENDS                                                  4
+#endif
+
+
+/**
+ * @brief Number of bins of the reception latency histogram. Bin 0 counts the
+ * latencies of 0 and 1 microseconds, bin n the latencies from 2^n to
+ * 2^(n+1) - 1 microseconds, and the last bin also counts all greater
+ * values. UART_LATENCY_HISTOGRAM_SIZE can be changed by defining it on
+ * setup.h file.
+ */
+#ifndef UART_LATENCY_HISTOGRAM_SIZE
+#define UART_LATENCY_HISTOGRAM_SIZE                                           16
+#endif
+
+
+/**
+ * @brief Builds a set of UART IDs (@ref UART_IdSet_t) holding only ID.
+ */
+#define UART_ID_SET(ID)                               ((UART_IdSet_t)1U << (ID))
+
+#if UART_MAX_ID > 32
+#error "UART_MAX_ID can not exceed the 32 IDs held by UART_IdSet_t"
+#endif
+
+
 /**
  * @brief Command to stop reception when used with UART_Read function.
  */
 #define UART_ABORT_RECEPTION                                                0x00
 
 
+/**
+ * @brief Byte the remote side sends for UART_DetectBaudRate to measure. Its
+ * alternating bits give an edge on every bit time.
+ */
+#define UART_AUTOBAUD_SYNC_BYTE                                             0x55
+
+
 /**
  * @brief List of UART ports and routed pins.
  */
@@ -61,16 +100,199 @@ typedef enum
   UART_NUMBER_OF_BAUDRATES,
 }UART_BaudRate_t;
 
+/**
+ * @brief List of flow control options.
+ * @note  CTS is used as the alternate function of the port (CTSE), which
+ *        holds the transmission while CTS is released. RTS is configured as
+ *        a GPIO output driven low by the driver while the reception ring
+ *        has room, hardware RTS (RTSE) is not used since the port would
+ *        drive it from its data register instead of from the ring fill.
+ *        The CTS and RTS pins used by each port are:
+ *        UART1_RX_PA10_TX_PA9 : CTS PA11, RTS PA12
+ *        UART2_RX_PD6_TX_PD5  : CTS PD3,  RTS PD4
+ *        UART2_RX_PA3_TX_PA2  : CTS PA0,  RTS PA1
+ *        UART3_RX_PD9_TX_PD8  : CTS PD11, RTS PD12
+ *        UART6_RX_PC7_TX_PC6  : CTS PG13, RTS PG8
+ */
+typedef enum
+{
+  UART_NO_FLOW_CONTROL = 0,
+  UART_RTS_CTS_FLOW_CONTROL,
+  UART_NUMBER_OF_FLOW_CONTROLS,
+}UART_FlowControl_t;
+
+/**
+ * @brief List of line modes.
+ * @note  In UART_RS485_HALF_DUPLEX mode the driver-enable (DE) pin of the
+ *        transceiver is asserted before a send starts and released from the
+ *        transmission complete interrupt, which fires at the end of the last
+ *        stop bit, so the bus is freed within one bit time at up to 921600
+ *        bps. The receiver is disabled while DE is asserted, so the own
+ *        transmission is not received back.
+ */
+typedef enum
+{
+  UART_FULL_DUPLEX = 0,
+  UART_RS485_HALF_DUPLEX,
+  UART_NUMBER_OF_MODES,
+}UART_Mode_t;
+
+/**
+ * @brief List of GPIO ports.
+ */
+typedef enum
+{
+  UART_GPIO_PORT_A = 0,
+  UART_GPIO_PORT_B,
+  UART_GPIO_PORT_C,
+  UART_GPIO_PORT_D,
+  UART_GPIO_PORT_E,
+  UART_GPIO_PORT_F,
+  UART_GPIO_PORT_G,
+  UART_GPIO_PORT_H,
+  UART_NUMBER_OF_GPIO_PORTS,
+}UART_GpioPort_t;
+
+/**
+ * @brief List of GPIO pins.
+ */
+typedef enum
+{
+  UART_GPIO_PIN_0 = 0,
+  UART_GPIO_PIN_1,
+  UART_GPIO_PIN_2,
+  UART_GPIO_PIN_3,
+  UART_GPIO_PIN_4,
+  UART_GPIO_PIN_5,
+  UART_GPIO_PIN_6,
+  UART_GPIO_PIN_7,
+  UART_GPIO_PIN_8,
+  UART_GPIO_PIN_9,
+  UART_GPIO_PIN_10,
+  UART_GPIO_PIN_11,
+  UART_GPIO_PIN_12,
+  UART_GPIO_PIN_13,
+  UART_GPIO_PIN_14,
+  UART_GPIO_PIN_15,
+  UART_NUMBER_OF_PINS,
+}UART_GpioPin_t;
+
+/**
+ * @brief List of polarities.
+ */
+typedef enum
+{
+  UART_ACTIVE_LOW  = 0,
+  UART_ACTIVE_HIGH,
+  UART_NUMBER_OF_POLARITIES,
+}UART_Polarity_t;
+
+/**
+ * @brief List of multiprocessor communication options.
+ * @note  In UART_ADDRESS_MARK mode characters have 9 bits, the 9th bit set
+ *        marking address bytes. The port stays muted, raising no interrupt
+ *        or DMA request, until an address byte matching NodeAddress arrives,
+ *        and mutes itself again on the next address byte that does not match.
+ *        The STM32F407 only compares the 4 least significant bits; on buses
+ *        with more than 16 nodes the driver checks the whole address byte on
+ *        wake-up and mutes the port again if it differs. The matched address
+ *        byte is stored as the first byte of the frame.
+ */
+typedef enum
+{
+  UART_MULTIPROCESSOR_DISABLED = 0,
+  UART_ADDRESS_MARK,
+  UART_NUMBER_OF_MULTIPROCESSOR_MODES,
+}UART_Multiprocessor_t;
+
 /**
  * @brief UART configuration structure.
  */
 typedef struct
 {
-  UART_Port_t     Port;
-  UART_BaudRate_t BaudRate;
-  uint32_t        ReceptionTimeOut_ms;
+  UART_Port_t           Port;
+  UART_BaudRate_t       BaudRate;
+  uint32_t              ReceptionTimeOut_ms;
+
+  UART_FlowControl_t    FlowControl;
+  uint32_t              RxHighWatermark;  /*!< Ring fill that releases RTS */
+  uint32_t              RxLowWatermark;   /*!< Ring fill that asserts RTS */
+
+  UART_Mode_t           Mode;
+  UART_GpioPort_t       DriverEnablePort; /*!< RS-485 transceiver DE pin */
+  UART_GpioPin_t        DriverEnablePin;
+  UART_Polarity_t       DriverEnablePolarity;
+
+  UART_Multiprocessor_t Multiprocessor;
+  uint8_t               NodeAddress;      /*!< Address of this node */
 }UART_Parameters_t;
 
+/**
+ * @brief List of events reported during ring reception.
+ */
+typedef enum
+{
+  UART_EVENT_IDLE_LINE = 0, /*!< Line went idle after receiving data */
+  UART_EVENT_HALF_RING,     /*!< Reception reached the middle of the ring */
+  UART_EVENT_FULL_RING,     /*!< Reception reached the end of the ring */
+  UART_EVENT_OVERRUN,       /*!< Unread data was overwritten */
+  UART_NUMBER_OF_EVENTS,
+}UART_Event_t;
+
+/**
+ * @brief Memory region given as a pointer and a length in bytes.
+ */
+typedef struct
+{
+  uint8_t  *Data;
+  uint32_t Length;
+}UART_Buffer_t;
+
+/**
+ * @brief Set of UART IDs, bit n stands for ID n.
+ */
+typedef uint32_t UART_IdSet_t;
+
+/**
+ * @brief Sets of UART IDs ready for each kind of operation.
+ */
+typedef struct
+{
+  UART_IdSet_t Rx;     /*!< IDs with received data waiting to be read */
+  UART_IdSet_t Tx;     /*!< IDs with room in the transmission queue */
+  UART_IdSet_t Error;  /*!< IDs that had reception errors */
+}UART_Readiness_t;
+
+/**
+ * @brief UART counters.
+ */
+typedef struct
+{
+  uint32_t BytesReceived;
+  uint32_t BytesSent;
+  uint32_t OverrunErrors;  /*!< Overruns of the port or of the ring */
+  uint32_t FramingErrors;
+  uint32_t NoiseErrors;
+  uint32_t ParityErrors;
+  uint32_t PeakRingFill;   /*!< Most bytes seen waiting in the ring */
+  uint32_t Latency[UART_LATENCY_HISTOGRAM_SIZE]; /*!< Reception latencies */
+}UART_Statistics_t;
+
+/**
+ * @brief Routine called by the driver to report a reception event.
+ * @note  It runs in interrupt context and should only flag the event.
+ */
+typedef void (*UART_EventCallback_t)(uint8_t ID, UART_Event_t Event);
+
+/**
+ * @brief Routine called by the driver when a queued send finishes.
+ * @note  Segments is the array given to UART_SendVector, which can be reused
+ *        from this point on. It runs in interrupt context.
+ */
+typedef void (*UART_SendCallback_t)(uint8_t ID, UART_Buffer_t *Segments,
+    EStatus_t Status);
+
+
 /**
  * @brief  UART configuration routine.
  * @param  ID : ID that should be allocated and configured.
@@ -112,4 +334,208 @@ EStatus_t UART_Read(uint8_t ID, uint8_t *RecBuffer, uint32_t RecLength);
  */
 EStatus_t UART_Reconfigure(uint8_t ID, UART_Parameters_t Parameter);
 
+
+/**
+ * @brief  Starts continuous reception into a ring buffer.
+ * @param  ID : UART ID number.
+ * @param  RingBuffer : Pointer to the memory used as reception ring.
+ * @param  RingSize : Size of the ring in bytes.
+ * @param  Callback : Routine called on every reception event, can be NULL.
+ * @retval EStatus_t
+ * @note
+ *         The DMA stream of the port writes in circular mode to RingBuffer,
+ *         so reception never stops while the caller is late. The ring is
+ *         read with UART_PeekRing and freed with UART_ReleaseRing.
+ *         UART_Read can not be used on this ID until UART_StopRingReception
+ *         is called.
+ *         With UART_RTS_CTS_FLOW_CONTROL, the DMA keeps running in circular
+ *         mode and the ring fill is checked on the half transfer, transfer
+ *         complete and idle-line interrupts, where the RTS GPIO is released
+ *         once the fill reaches RxHighWatermark, and in UART_ReleaseRing,
+ *         where it is asserted again once the fill drops to RxLowWatermark.
+ *         Up to RingSize / 2 bytes can arrive between two checks, so
+ *         RxHighWatermark must leave that room plus the characters the
+ *         remote side still sends after RTS is released. Zero watermarks
+ *         stand for 3/8 and 1/8 of RingSize.
+ */
+EStatus_t UART_StartRingReception(uint8_t ID, uint8_t *RingBuffer,
+    uint32_t RingSize, UART_EventCallback_t Callback);
+
+
+/**
+ * @brief  Gives access to the unread data of the reception ring.
+ * @param  ID : UART ID number.
+ * @param  First : Region holding the oldest unread bytes.
+ * @param  Second : Region holding the bytes written after the ring wrapped
+ *         around, its Length is zero if the ring did not wrap.
+ * @retval EStatus_t
+ * @note
+ *         The regions point straight into the ring, no data is copied. They
+ *         stay valid until released with UART_ReleaseRing.
+ *         OPERATION_RUNNING is returned while the ring is empty.
+ */
+EStatus_t UART_PeekRing(uint8_t ID, UART_Buffer_t *First,
+    UART_Buffer_t *Second);
+
+
+/**
+ * @brief  Frees bytes of the reception ring after they were processed.
+ * @param  ID : UART ID number.
+ * @param  Length : How many bytes, starting at the oldest one, to free.
+ * @retval EStatus_t
+ * @note
+ *         If unread data is overwritten, UART_EVENT_OVERRUN is reported and
+ *         the unread data is discarded; the ring restarts from the position
+ *         the DMA is writing to.
+ */
+EStatus_t UART_ReleaseRing(uint8_t ID, uint32_t Length);
+
+
+/**
+ * @brief  Stops the ring reception started by UART_StartRingReception.
+ * @param  ID : UART ID number.
+ * @retval EStatus_t
+ */
+EStatus_t UART_StopRingReception(uint8_t ID);
+
+
+/**
+ * @brief  Queues a send made of several memory regions.
+ * @param  ID : UART ID number.
+ * @param  Segments : Array with the regions to send, in order.
+ * @param  NumberOfSegments : How many regions Segments holds.
+ * @param  Callback : Routine called when the send finishes, can be NULL.
+ * @retval EStatus_t
+ * @note
+ *         The routine returns right away; the regions are sent one after the
+ *         other by the DMA, without being copied, so Segments and the data it
+ *         points to must not change until Callback is called.
+ *         Up to UART_MAX_QUEUED_SENDS sends can wait behind the one being
+ *         transmitted; when the queue is full an error is returned and
+ *         nothing is queued.
+ */
+EStatus_t UART_SendVector(uint8_t ID, UART_Buffer_t *Segments,
+    uint8_t NumberOfSegments, UART_SendCallback_t Callback);
+
+
+/**
+ * @brief  Routine to send an address byte on a multi-drop bus.
+ * @param  ID : UART ID number.
+ * @param  Address : Address of the node that should wake up.
+ * @retval EStatus_t
+ * @note   The byte is sent with the 9th bit set, so it is only available in
+ *         UART_ADDRESS_MARK mode. Bytes sent afterwards with UART_Send or
+ *         UART_SendVector have the 9th bit cleared and reach only the nodes
+ *         woken up by Address. The address is queued like any other send.
+ */
+EStatus_t UART_SendAddress(uint8_t ID, uint8_t Address);
+
+
+/**
+ * @brief  Routine that waits until any of a set of UART IDs is ready.
+ * @param  Interest : Set of UART IDs to check.
+ * @param  Ready : Pointer to store the IDs of Interest that are ready.
+ * @param  TimeOut_ms : Maximum waiting time, zero to return right away.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: At least one ID is ready.
+ *         @arg OPERATION_RUNNING: No ID got ready within TimeOut_ms.
+ *         @arg Else: Some error happened.
+ * @note
+ *         The sets are kept up to date by the UART interrupts, so this
+ *         routine does not access any port. Rx stays set until the received
+ *         data is read, Error is cleared once it is returned.
+ *         The ready IDs are visited in O(ready IDs) by taking the lowest set
+ *         bit until the set is empty, for instance with __builtin_ctz.
+ */
+EStatus_t UART_Wait(UART_IdSet_t Interest, UART_Readiness_t *Ready,
+    uint32_t TimeOut_ms);
+
+
+/**
+ * @brief  This routine returns the counters of a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ * @note
+ *         The reception latency goes from the interrupt that made the data
+ *         available, timestamped with PIT_GetMicroseconds, to the call of
+ *         UART_Read or UART_PeekRing that hands it to the caller. Its bin is
+ *         31 - __builtin_clz(Latency | 1), so no division is done and a
+ *         zero latency, which falls in bin 0, never reaches __builtin_clz(0).
+ *         Each counter has a single writer, so increments need no locking:
+ *         the byte and error counters and PeakRingFill are written by the
+ *         port interrupts, PeakRingFill at the half transfer, transfer
+ *         complete and idle-line checks of the ring fill, and Latency by
+ *         the caller. The counters are copied one by one and are not a
+ *         snapshot of a single instant. The byte and error counters returned
+ *         are the counters minus the baseline taken by the last
+ *         UART_ClearStatistics.
+ */
+EStatus_t UART_GetStatistics(uint8_t ID, UART_Statistics_t *Statistics);
+
+
+/**
+ * @brief  This routine resets the counters of a UART ID.
+ * @param  ID : UART ID number.
+ * @retval EStatus_t
+ * @note   The counters written by the interrupt are never touched by this
+ *         routine: a copy of them is kept as baseline and subtracted by
+ *         UART_GetStatistics, so no increment is lost and the single writer
+ *         rule holds. PeakRingFill is a maximum, which a baseline can not
+ *         reset, so a reset flag is set instead; the interrupt stores the
+ *         current fill as new peak on its next check and clears the flag,
+ *         and PeakRingFill reads zero until then. Counters owned by the
+ *         caller are zeroed directly.
+ */
+EStatus_t UART_ClearStatistics(uint8_t ID);
+
+
+/**
+ * @brief  Routine that detects the baud rate used by the remote side.
+ * @param  ID : UART ID number.
+ * @param  BaudRate : Pointer to store the detected baud rate.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The baud rate was detected and applied.
+ *         @arg OPERATION_RUNNING: Waiting for UART_AUTOBAUD_SYNC_BYTE.
+ *         @arg Else: Some error happened.
+ * @note
+ *         The first call starts timestamping the edges of the RX pin; it
+ *         must be called again until it stops returning OPERATION_RUNNING.
+ *         The time from the start bit to the last data edge of the sync
+ *         byte gives the bit time, and the closest entry of UART_BaudRate_t
+ *         within 3% is taken. The sync byte is not stored.
+ *         The edges are captured by the timer channel mapped on the RX pin:
+ *         UART1_RX_PA10_TX_PA9 : TIM1 CH3
+ *         UART2_RX_PA3_TX_PA2  : TIM5 CH4
+ *         UART6_RX_PC7_TX_PC6  : TIM3 CH2
+ *         PD6 and PD9 have no timer input on the STM32F407, so on
+ *         UART2_RX_PD6_TX_PD5 and UART3_RX_PD9_TX_PD8 the edges raise the
+ *         EXTI line of the pin instead, timestamped with the DWT cycle
+ *         counter. The interrupt latency then limits the detection to
+ *         UART_460800_BPS, and an error is returned if the EXTI line is
+ *         already used by another pin.
+ */
+EStatus_t UART_DetectBaudRate(uint8_t ID, UART_BaudRate_t *BaudRate);
+
+
+/**
+ * @brief  Routine that changes the baud rate without losing data.
+ * @param  ID : UART ID number.
+ * @param  BaudRate : The desired baud rate.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The new baud rate is in use.
+ *         @arg OPERATION_RUNNING: Waiting for the sends queued to finish.
+ *         @arg Else: Some error happened.
+ * @note
+ *         Unlike UART_Reconfigure, the port is not torn down: queued sends go
+ *         out at the old baud rate, only the baud rate register is rewritten
+ *         and the reception ring keeps its content and position. New sends
+ *         are refused until the change is done.
+ *         It must be called again until it stops returning OPERATION_RUNNING.
+ */
+EStatus_t UART_ChangeBaudRate(uint8_t ID, UART_BaudRate_t BaudRate);
+
 #endif /* UART_H */
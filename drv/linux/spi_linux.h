@@ -0,0 +1,110 @@
+/**
+ * @file  spi_linux.h
+ * @date  17-October-2026
+ * @brief Simulated SPI bus for the Linux build of the SPI driver.
+ *
+ * The Linux build implements the routines of spi.h on a simulated bus, where
+ * each chip select (port and pin) is wired to a device model. The bus time
+ * of every byte is accounted from the configured prescaler, so protocol
+ * efficiency can be measured on a host computer. This header file contains
+ * the prototypes available only on that build.
+ *
+ * @author
+ * @author
+ */
+
+#ifndef SPI_LINUX_H
+#define SPI_LINUX_H
+
+#include <stdint.h>
+#include "stdstatus.h"
+#include "spi.h"
+
+
+/**
+ * @brief Device model structure.
+ * @note  Exchange is called once per byte clocked while the device is
+ *        selected; it returns the byte driven on MISO and sets *Payload to
+ *        one when the byte carried useful data (command arguments, register
+ *        values, data blocks), and to zero for polling, padding and tokens.
+ */
+typedef struct
+{
+  void    *Context;                                     /*!< Model state */
+  void    (*Select)(void *Context, uint8_t Selected);   /*!< CS edges */
+  uint8_t (*Exchange)(void *Context, uint8_t Mosi, uint8_t *Payload);
+} SPI_LINUX_Device_t;
+
+/**
+ * @brief Counters of a chip select.
+ */
+typedef struct
+{
+  uint32_t Selections;    /*!< Times CS was asserted */
+  uint64_t ClockedBytes;  /*!< Bytes clocked while selected */
+  uint64_t PayloadBytes;  /*!< Bytes that carried useful data */
+  uint64_t BusTime_ns;    /*!< From the prescaler and the port clock */
+} SPI_LINUX_Statistics_t;
+
+
+/**
+ * @brief  Wires a device model to a chip select.
+ * @param  Port : GPIO port of the chip select.
+ * @param  Pin : GPIO pin of the chip select.
+ * @param  Device : The device model.
+ * @retval EStatus_t
+ * @note   Bytes clocked with no device selected read back as 0xFF.
+ */
+EStatus_t SPI_LINUX_Attach(SPI_ChipSelectPort_t Port, SPI_ChipSelectPin_t Pin,
+    SPI_LINUX_Device_t Device);
+
+
+/**
+ * @brief  Creates an SD card model backed by an image file.
+ * @param  Device : Pointer to store the model.
+ * @param  ImagePath : Path of the image, its size gives the card capacity.
+ * @retval EStatus_t
+ * @note   The model behaves as an SDHC card in SPI mode: it answers the
+ *         identification commands (CMD0, CMD8, ACMD41, CMD58, CMD9, CMD10),
+ *         single and multiple block reads and writes, and checks CRCs once
+ *         enabled with CMD59. The CSD reports a 25 MHz maximum clock.
+ */
+EStatus_t SPI_LINUX_CreateSdCard(SPI_LINUX_Device_t *Device,
+    const char *ImagePath);
+
+
+/**
+ * @brief  Creates a register file model.
+ * @param  Device : Pointer to store the model.
+ * @param  Registers : Memory holding the register values.
+ * @param  Size : Number of registers, up to 128.
+ * @retval EStatus_t
+ * @note   The first byte after CS is asserted gives the register address in
+ *         bits 6..0 and a read when bit 7 is set; the following bytes read or
+ *         write consecutive registers.
+ */
+EStatus_t SPI_LINUX_CreateRegisterFile(SPI_LINUX_Device_t *Device,
+    uint8_t *Registers, uint32_t Size);
+
+
+/**
+ * @brief  Creates a loopback model, which sends back on MISO every byte
+ *         received on MOSI.
+ * @param  Device : Pointer to store the model.
+ * @retval EStatus_t
+ */
+EStatus_t SPI_LINUX_CreateLoopback(SPI_LINUX_Device_t *Device);
+
+
+/**
+ * @brief  This routine returns the counters of a chip select.
+ * @param  Port : GPIO port of the chip select.
+ * @param  Pin : GPIO pin of the chip select.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ * @note   PayloadBytes / ClockedBytes is the protocol efficiency.
+ */
+EStatus_t SPI_LINUX_GetStatistics(SPI_ChipSelectPort_t Port,
+    SPI_ChipSelectPin_t Pin, SPI_LINUX_Statistics_t *Statistics);
+
+#endif /* SPI_LINUX_H */
@@ -0,0 +1,123 @@
+/**
+ * @file  uart_linux.h
+ * @date  17-October-2026
+ * @brief Host backends for the Linux build of the UART driver.
+ *
+ * The Linux build implements the routines of uart.h on a host computer, so
+ * protocol code can be exercised and load tested without hardware. Each ID
+ * is backed either by a simulated line, driven from the same process, or by
+ * a pseudo-terminal that other programs open as a serial port. Both model
+ * the time a byte takes at the configured baud rate and can inject faults.
+ * This header file contains the prototypes available only on that build.
+ *
+ * @author
+ * @author
+ */
+
+#ifndef UART_LINUX_H
+#define UART_LINUX_H
+
+#include <stdint.h>
+#include "stdstatus.h"
+#include "uart.h"
+
+
+/**
+ * @brief List of backends for a UART ID.
+ */
+typedef enum
+{
+  UART_LINUX_SIMULATED_LINE = 0, /*!< Driven by UART_LINUX_Receive and
+                                      UART_LINUX_Transmitted */
+  UART_LINUX_PSEUDO_TERMINAL,    /*!< Bytes go through a pseudo-terminal */
+  UART_LINUX_NUMBER_OF_BACKENDS,
+} UART_LINUX_Backend_t;
+
+/**
+ * @brief Fault injection configuration structure.
+ * @note  Rates are given in faults per million bytes; zero disables a fault.
+ */
+typedef struct
+{
+  uint32_t FramingErrors_ppm; /*!< Bytes received with a framing error */
+  uint32_t DroppedBytes_ppm;  /*!< Bytes lost before reaching the ring */
+  uint32_t Seed;              /*!< Seed of the pseudo-random generator */
+} UART_LINUX_Faults_t;
+
+
+/**
+ * @brief  Selects the backend of a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Backend : The desired backend.
+ * @retval EStatus_t
+ * @note   It must be called before UART_Init, UART_LINUX_SIMULATED_LINE is
+ *         used otherwise.
+ */
+EStatus_t UART_LINUX_SetBackend(uint8_t ID, UART_LINUX_Backend_t Backend);
+
+
+/**
+ * @brief  Returns the path of the pseudo-terminal backing a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Path : Pointer to store the path, such as /dev/pts/3.
+ * @param  PathSize : Size of Path in bytes.
+ * @retval EStatus_t
+ * @note   The pseudo-terminal is created by UART_Init. Programs opening it
+ *         see a serial port; its termios settings are ignored.
+ */
+EStatus_t UART_LINUX_GetTerminal(uint8_t ID, char *Path, uint32_t PathSize);
+
+
+/**
+ * @brief  Enables or disables the baud-rate timing of a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Enable : If not zero, each byte takes 10 bit times to move.
+ * @retval EStatus_t
+ * @note   Timing is enabled by default, so 115200 bps moves about 11.5 kB/s
+ *         in each direction, idle-line events come one character after the
+ *         last byte and UART_Reconfigure changes the pace. Disabling it makes
+ *         functional tests run as fast as possible.
+ */
+EStatus_t UART_LINUX_SetTiming(uint8_t ID, uint8_t Enable);
+
+
+/**
+ * @brief  Configures the faults injected on reception of a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Faults : The desired fault rates.
+ * @retval EStatus_t
+ * @note   A byte with a framing error is stored with its bits corrupted and
+ *         flagged the same way the hardware does it.
+ */
+EStatus_t UART_LINUX_SetFaults(uint8_t ID, UART_LINUX_Faults_t Faults);
+
+
+/**
+ * @brief  Makes bytes arrive at the RX pin of a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Data : Pointer to the bytes that arrive.
+ * @param  Length : How many bytes arrive.
+ * @param  Idle : If not zero, the line goes idle after the last byte.
+ * @retval EStatus_t
+ * @note   The bytes are written to the reception ring the same way the DMA
+ *         does it on target, so wrap-around and UART_EVENT_OVERRUN can be
+ *         tested. Events are reported from the calling thread.
+ *         Only available with the UART_LINUX_SIMULATED_LINE backend.
+ */
+EStatus_t UART_LINUX_Receive(uint8_t ID, uint8_t *Data, uint32_t Length,
+    uint8_t Idle);
+
+
+/**
+ * @brief  Collects the bytes that left the TX pin of a UART ID.
+ * @param  ID : UART ID number.
+ * @param  Buffer : Pointer to store the transmitted bytes.
+ * @param  BufferSize : Size of Buffer in bytes.
+ * @param  Length : Pointer to store how many bytes were copied.
+ * @retval EStatus_t
+ * @note   Only available with the UART_LINUX_SIMULATED_LINE backend.
+ */
+EStatus_t UART_LINUX_Transmitted(uint8_t ID, uint8_t *Buffer,
+    uint32_t BufferSize, uint32_t *Length);
+
+#endif /* UART_LINUX_H */
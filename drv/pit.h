@@ -64,6 +64,23 @@ EStatus_t PIT_Set(uint8_t ID, uint32_t CountsToPerform, PIT_TimeUnit_t Unit);
  */
 EStatus_t PIT_Get(uint8_t ID);
 
+/**
+ * @brief  Routine called by the driver when the count of an ID ends.
+ * @note   It runs in interrupt context.
+ */
+typedef void (*PIT_Callback_t)(uint8_t ID);
+
+/**
+ * @brief  Routine that sets the routine called when the count of an ID ends.
+ * @param  ID : Requester's ID
+ * @param  Callback : Routine called from the PIT interrupt when the count
+ *         started by PIT_Set ends, NULL to call nothing.
+ * @retval EStatus_t
+ * @note   It lets drivers enforce time limits on operations that raise no
+ *         interrupt of their own once stuck. PIT_Get keeps working as well.
+ */
+EStatus_t PIT_SetCallback(uint8_t ID, PIT_Callback_t Callback);
+
 /**
  * @brief  Stop driver's operation.
  * @retval Result : Result of Operation.
@@ -87,4 +104,13 @@ EStatus_t PIT_Halt(void);
  */
 EStatus_t PIT_Resume(void);
 
+/**
+ * @brief  Routine that returns a free-running timestamp.
+ * @retval Microseconds elapsed since the driver started, wrapping around at
+ *         2^32. Intervals are computed by unsigned subtraction.
+ * @note   This routine can be called from interrupt context, it is used to
+ *         timestamp events that need a finer resolution than PIT_Set offers.
+ */
+uint32_t PIT_GetMicroseconds(void);
+
 #endif  /* __PIT_H */
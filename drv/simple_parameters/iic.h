@@ -27,6 +27,32 @@
 #endif
 
 
+/**
+ * @brief Maximum number of transactions that can wait for each IIC port.
+ * IIC_MAX_QUEUED_TRANSACTIONS can be changed by defining it on setup.h file.
+ */
+#ifndef IIC_MAX_QUEUED_TRANSACTIONS
+#define IIC_MAX_QUEUED_TRANSACTIONS                                            8
+#endif
+
+
+/**
+ * @brief Time limit of a transaction when the ID does not set TimeOut_ms.
+ * IIC_DEFAULT_TIMEOUT_ms can be changed by defining it on setup.h file.
+ */
+#ifndef IIC_DEFAULT_TIMEOUT_ms
+#define IIC_DEFAULT_TIMEOUT_ms                                                10
+#endif
+
+
+/**
+ * @brief Flags kept for each register of a shadow (@ref IIC_Shadow_t).
+ */
+#define IIC_SHADOW_VOLATILE                                                 0x01
+#define IIC_SHADOW_VALID                                                    0x02
+#define IIC_SHADOW_DIRTY                                                    0x04
+
+
 /**
  * @brief List of IIC ports and routed pins.
  */
@@ -81,9 +107,49 @@ typedef enum
   IIC_NUMBER_OF_PULL_OPTIONS,
 } IIC_PullUp_t;
 
+/**
+ * @brief List of priorities used to share a port between IDs.
+ * @note
+ *        Transactions from IDs on the same port wait in a queue of up to
+ *        IIC_MAX_QUEUED_TRANSACTIONS entries and run one at a time, highest
+ *        priority first and in order of arrival within a priority. Transfers
+ *        longer than MaxChunkSize are split as set by Split, and the queue is
+ *        checked between chunks, so a high priority read waits at most for
+ *        one chunk of a large display write.
+ */
+typedef enum
+{
+  IIC_PRIORITY_LOW = 0,
+  IIC_PRIORITY_NORMAL,
+  IIC_PRIORITY_HIGH,
+  IIC_NUMBER_OF_PRIORITIES,
+} IIC_Priority_t;
+
+/**
+ * @brief List of options to split long transfers into chunks.
+ */
+typedef enum
+{
+  IIC_SPLIT_DISABLED = 0,  /*!< Transfers always run whole */
+  IIC_SPLIT_SAME_REGISTER, /*!< Every chunk goes to Register, for data
+                                streams such as display memory */
+  IIC_SPLIT_NEXT_REGISTER, /*!< Chunks go to Register plus their offset, for
+                                devices that increment the register address */
+  IIC_NUMBER_OF_SPLIT_OPTIONS,
+} IIC_Split_t;
+
 
 /**
  * @brief IIC configuration structure.
+ * @note  The STM32F4 I2C has no time-out of its own, so TimeOut_ms and
+ *        ClockStretchLimit_us are enforced by the driver: while a
+ *        transaction runs, blocking or not, the PIT ID IIC_PIT_ID, defined
+ *        on setup.h, calls back every millisecond (PIT_SetCallback). A
+ *        transaction still running TimeOut_ms after it started is aborted.
+ *        Every port event is timestamped with PIT_GetMicroseconds, and a
+ *        clock stretch fault is declared when SCL reads low and no event
+ *        came for nine bit times plus ClockStretchLimit_us, so the limit is
+ *        checked with a resolution of 1 ms.
  */
 typedef struct
 {
@@ -93,8 +159,64 @@ typedef struct
   IIC_BaudRate_t    BaudRate;
   IIC_PullUp_t      PullUpOption;
   IIC_RegAddrSize_t RegAddrSize;  /*!< Size of the address inside the device */
+
+  IIC_Priority_t    Priority;
+  IIC_Split_t       Split;
+  uint16_t          MaxChunkSize; /*!< Bytes per chunk, zero for no limit */
+
+  uint32_t          TimeOut_ms;           /*!< Zero: IIC_DEFAULT_TIMEOUT_ms */
+  uint32_t          ClockStretchLimit_us; /*!< Zero for no limit */
 }IIC_Parameters_t;
 
+/**
+ * @brief Routine called by the driver when an asynchronous transfer ends.
+ * @note  It runs in interrupt context.
+ */
+typedef void (*IIC_Callback_t)(uint8_t ID, EStatus_t Status);
+
+/**
+ * @brief Counters of an IIC ID.
+ */
+typedef struct
+{
+  uint32_t Transactions;
+  uint32_t MaxQueueDelay_us;  /*!< Longest wait for the port */
+  uint32_t MaxLatency_us;     /*!< Longest time from request to end */
+} IIC_Statistics_t;
+
+/**
+ * @brief Fault counters of an IIC port.
+ */
+typedef struct
+{
+  uint32_t TimeOuts;            /*!< Transactions aborted after TimeOut_ms */
+  uint32_t ClockStretchFaults;  /*!< SCL held low past ClockStretchLimit_us */
+  uint32_t BusRecoveries;       /*!< Bus released by SCL pulses and STOP */
+  uint32_t PeripheralResets;    /*!< Recoveries that also reset the port */
+  uint32_t HardFaults;          /*!< SDA still held low after a recovery */
+} IIC_BusStatistics_t;
+
+/**
+ * @brief Register shadow structure, one byte per 8 bits register.
+ * @note
+ *        Registers lists the addresses of a sparse map, sorted in increasing
+ *        order; if it is NULL the shadow is the dense range starting at
+ *        FirstRegister. A dense range with zero NumberOfRegisters covers the
+ *        256 registers of IIC_8_BITS; it is rejected by IIC_ShadowInit for
+ *        wider RegAddrSize, whose address space can not be shadowed whole.
+ *        The caller sets IIC_SHADOW_VOLATILE in Flags for registers the
+ *        device changes by itself, such as status and data registers; they
+ *        are never cached.
+ */
+typedef struct
+{
+  uint32_t *Registers;         /*!< Sparse map addresses, or NULL */
+  uint32_t FirstRegister;      /*!< First address of a dense range */
+  uint32_t NumberOfRegisters;
+  uint8_t  *Values;            /*!< Cached register values */
+  uint8_t  *Flags;             /*!< IIC_SHADOW_* flags of each register */
+} IIC_Shadow_t;
+
 
 /**
  * @brief  Routine to configure an IIC port.
@@ -113,6 +235,8 @@ EStatus_t IIC_Init(uint8_t ID, IIC_Parameters_t Parameter);
  * @param  SendBuffer : Pointer to where the data is.
  * @param  SendLength : How many bytes to send.
  * @retval EStatus_t
+ * @note   The transaction is aborted after TimeOut_ms and the bus recovered
+ *         as IIC_RecoverBus does, so a stuck device costs one failed call.
  */
 EStatus_t IIC_Send(uint8_t ID, uint32_t Register, uint8_t *SendBuffer,
     uint32_t SendLength);
@@ -125,6 +249,8 @@ EStatus_t IIC_Send(uint8_t ID, uint32_t Register, uint8_t *SendBuffer,
  * @param  RecBuffer : Pointer to store the received data.
  * @param  RecLength : Maximum amount of data to receive.
  * @retval EStatus_t
+ * @note   The transaction is aborted after TimeOut_ms and the bus recovered
+ *         as IIC_RecoverBus does, so a stuck device costs one failed call.
  */
 EStatus_t IIC_Read(uint8_t ID, uint32_t Register, uint8_t *RecBuffer,
     uint16_t RecLength);
@@ -138,4 +264,202 @@ EStatus_t IIC_Read(uint8_t ID, uint32_t Register, uint8_t *RecBuffer,
  */
 EStatus_t IIC_Reconfigure(uint8_t ID, IIC_Parameters_t Parameter);
 
+
+/**
+ * @brief  Routine that starts sending data.
+ * @param  ID : IIC ID number.
+ * @param  Register : Address of a register position in the IIC device.
+ * @param  SendBuffer : Pointer to where the data is.
+ * @param  SendLength : How many bytes to send.
+ * @param  Callback : Routine called when the transfer ends, can be NULL.
+ * @retval EStatus_t
+ * @note
+ *         The routine returns right away. The start condition, device and
+ *         register addresses are handled by the port interrupts and the data
+ *         is moved by DMA, up to the stop condition. The buffer must not
+ *         change until the end is reported by Callback and by IIC_GetStatus.
+ *         As for IIC_Send, the transaction is aborted after TimeOut_ms even
+ *         if the port raises no further interrupt, see IIC_Parameters_t:
+ *         the bus is recovered with IIC_RecoverBus and an error is reported
+ *         through Callback and IIC_GetStatus.
+ */
+EStatus_t IIC_SendAsync(uint8_t ID, uint32_t Register, uint8_t *SendBuffer,
+    uint32_t SendLength, IIC_Callback_t Callback);
+
+
+/**
+ * @brief  Routine that starts receiving data.
+ * @param  ID : IIC ID number.
+ * @param  Register : Address of a register position in the IIC device.
+ * @param  RecBuffer : Pointer to store the received data.
+ * @param  RecLength : How many bytes to receive.
+ * @param  Callback : Routine called when the transfer ends, can be NULL.
+ * @retval EStatus_t
+ * @note   Works as IIC_SendAsync; the register address is followed by a
+ *         repeated start. From 2 bytes on, the port NACKs the last byte on
+ *         its own once the DMA reaches the end of RecBuffer (LAST bit). The
+ *         DMA path can not NACK a single byte, so a RecLength of 1 is
+ *         handled by the event interrupt instead: ACK is cleared before ADDR
+ *         is cleared, STOP is set right after, and the byte is read on RXNE.
+ */
+EStatus_t IIC_ReadAsync(uint8_t ID, uint32_t Register, uint8_t *RecBuffer,
+    uint16_t RecLength, IIC_Callback_t Callback);
+
+
+/**
+ * @brief  Routine that checks if an asynchronous transfer has ended.
+ * @param  ID : IIC ID number.
+ * @retval Result : Result of Operation.
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The last transfer ended successfully.
+ *         @arg OPERATION_RUNNING: The transfer is still running.
+ *         @arg Else: Some error happened.
+ */
+EStatus_t IIC_GetStatus(uint8_t ID);
+
+
+/**
+ * @brief  This routine returns the counters of an IIC ID.
+ * @param  ID : IIC ID number.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t IIC_GetStatistics(uint8_t ID, IIC_Statistics_t *Statistics);
+
+
+/**
+ * @brief  This routine resets the counters of an IIC ID.
+ * @param  ID : IIC ID number.
+ * @retval EStatus_t
+ * @note   As with UART_ClearStatistics, Transactions, written by the
+ *         interrupt, is kept and a baseline is subtracted from it.
+ *         MaxQueueDelay_us and MaxLatency_us are maxima, so a reset flag is
+ *         set instead: the interrupt stores the next values as new maxima
+ *         and clears the flag, and both read zero until then.
+ */
+EStatus_t IIC_ClearStatistics(uint8_t ID);
+
+
+/**
+ * @brief  Attaches a register shadow to an IIC ID.
+ * @param  ID : IIC ID number.
+ * @param  Shadow : The shadow, whose memory must stay valid while in use.
+ * @retval EStatus_t
+ * @note   Every register starts not valid; only IIC_SHADOW_VOLATILE is kept
+ *         from Flags. An error is returned for a dense range with zero
+ *         NumberOfRegisters unless RegAddrSize is IIC_8_BITS.
+ */
+EStatus_t IIC_ShadowInit(uint8_t ID, IIC_Shadow_t Shadow);
+
+
+/**
+ * @brief  Reads a register through the shadow.
+ * @param  ID : IIC ID number.
+ * @param  Register : Address of a register position in the IIC device.
+ * @param  Value : Pointer to store the register value.
+ * @retval EStatus_t
+ * @note   The bus is only used when the register is volatile, not valid, or
+ *         not part of the shadow.
+ */
+EStatus_t IIC_ShadowRead(uint8_t ID, uint32_t Register, uint8_t *Value);
+
+
+/**
+ * @brief  Writes a register in the shadow, to be sent by IIC_ShadowFlush.
+ * @param  ID : IIC ID number.
+ * @param  Register : Address of a register position in the IIC device.
+ * @param  Value : The new register value.
+ * @retval EStatus_t
+ * @note   The bus is not used for cached registers. Volatile registers,
+ *         such as those holding self-clearing reset bits, and registers not
+ *         part of the shadow are written at once with IIC_Send and are never
+ *         left dirty. Registers still dirty are flushed first, as
+ *         IIC_ShadowFlush does, so writes reach the device in program order:
+ *         configuration written before a reset bit is sent before it.
+ */
+EStatus_t IIC_ShadowWrite(uint8_t ID, uint32_t Register, uint8_t Value);
+
+
+/**
+ * @brief  Changes bits of a register in the shadow, to be sent by
+ *         IIC_ShadowFlush.
+ * @param  ID : IIC ID number.
+ * @param  Register : Address of a register position in the IIC device.
+ * @param  Mask : Bits to change.
+ * @param  Value : New value of the bits set in Mask.
+ * @retval EStatus_t
+ * @note   The register is read from the device only if it is not valid yet,
+ *         so repeated read-modify-write sequences cost no bus transaction.
+ *         Volatile registers and registers not part of the shadow always get
+ *         a real IIC_Read followed by an IIC_Send, after the dirty registers
+ *         were flushed, as IIC_ShadowWrite does.
+ */
+EStatus_t IIC_ShadowModify(uint8_t ID, uint32_t Register, uint8_t Mask,
+    uint8_t Value);
+
+
+/**
+ * @brief  Sends the registers changed in the shadow to the device.
+ * @param  ID : IIC ID number.
+ * @retval EStatus_t
+ * @note   Each run of consecutive dirty registers is sent as a single
+ *         IIC_Send burst, which requires a device that increments the
+ *         register address on writes, as most sensors do.
+ */
+EStatus_t IIC_ShadowFlush(uint8_t ID);
+
+
+/**
+ * @brief  Marks every register of the shadow as not valid, after a device
+ *         reset for instance.
+ * @param  ID : IIC ID number.
+ * @retval EStatus_t
+ * @note   Changes not flushed yet are lost.
+ */
+EStatus_t IIC_ShadowInvalidate(uint8_t ID);
+
+
+/**
+ * @brief  Routine that releases a stuck IIC bus.
+ * @param  Port : IIC port.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The bus is free.
+ *         @arg Else: SDA is still held low, a hard bus fault.
+ * @note
+ *         The pins are taken as GPIO and SCL is pulsed, up to nine times,
+ *         until the device holding SDA low releases it; a STOP condition is
+ *         then generated and the port is given back to the peripheral. If
+ *         BUSY is still set after the STOP, the STM32F4 port itself is
+ *         locked up and it is reset through its SWRST bit and configured
+ *         again. A reset can not release a line held low by a device, so if
+ *         SDA stays low a hard bus fault is counted and returned, and the
+ *         transactions queued on the port end with an error. The port is not
+ *         left disabled: every new transaction on a port with a hard fault
+ *         first calls this routine again and runs if the bus is free, so a
+ *         device that browned out only costs the transactions issued while
+ *         it held SDA low. Otherwise, transactions of every ID on the port
+ *         that were queued are kept. It is called by the driver itself
+ *         after time outs and clock stretch faults.
+ */
+EStatus_t IIC_RecoverBus(IIC_Port_t Port);
+
+
+/**
+ * @brief  This routine returns the fault counters of an IIC port.
+ * @param  Port : IIC port.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t IIC_GetBusStatistics(IIC_Port_t Port,
+    IIC_BusStatistics_t *Statistics);
+
+
+/**
+ * @brief  This routine resets the fault counters of an IIC port.
+ * @param  Port : IIC port.
+ * @retval EStatus_t
+ */
+EStatus_t IIC_ClearBusStatistics(IIC_Port_t Port);
+
 #endif /* IIC_H */
@@ -1,7 +1,8 @@
 /**
  * @file  spi.h
  * @date  18-December-2020
- * @brief Configuration and access of Serial Peripheral Interfaces as master.
+ * @brief Configuration and access of Serial Peripheral Interfaces as master
+ *        or slave.
  *
  * @author
  * @author
@@ -27,6 +28,15 @@
 #endif
 
 
+/**
+ * @brief Maximum number of transactions that can wait for each SPI port.
+ * SPI_MAX_QUEUED_TRANSACTIONS can be changed by defining it on setup.h file.
+ */
+#ifndef SPI_MAX_QUEUED_TRANSACTIONS
+#define SPI_MAX_QUEUED_TRANSACTIONS                                            8
+#endif
+
+
 /**
  * @brief List of SPI ports and routed pins.
  * COPI = Controller Out Peripheral In
@@ -71,6 +81,97 @@ typedef enum
                             by the caller */
 }SPI_CS_Options;
 
+/**
+ * @brief List of frame sizes.
+ * @note  With SPI_16_BITS_FRAME buffers are accessed as arrays of uint16_t in
+ *        the CPU byte order, so no byte swapping is needed for 16 bit words,
+ *        and lengths still count bytes and must be even. Each frame is sent
+ *        most significant byte first, so on the little endian Cortex-M4 a
+ *        byte stream, such as an SD card sector, goes out with every byte
+ *        pair swapped; byte streams should use SPI_8_BITS_FRAME.
+ */
+typedef enum
+{
+  SPI_8_BITS_FRAME = 0,
+  SPI_16_BITS_FRAME,
+  SPI_NUMBER_OF_FRAME_SIZES,
+} SPI_FrameSize_t;
+
+/**
+ * @brief List of hardware CRC options.
+ * @note  With SPI_CRC_ENABLED the port computes the CRC of every send, read
+ *        or transfer (or of every SPI_Execute segment), sends it right after
+ *        the last data frame and checks the CRC received at the same time;
+ *        a mismatch is returned as an error status. The CRC has the size of
+ *        a frame; a zero CrcPolynomial selects 0x07 for 8 bit frames and
+ *        0x1021 (CRC16-CCITT) for 16 bit frames. The 16 bit CRC is only of
+ *        use for SD card data blocks if the block is stored as big endian
+ *        words, see SPI_FrameSize_t; with SPI_8_BITS_FRAME the SD CRC16 has
+ *        to be computed in software.
+ */
+typedef enum
+{
+  SPI_CRC_DISABLED = 0,
+  SPI_CRC_ENABLED,
+  SPI_NUMBER_OF_CRC_OPTIONS,
+} SPI_Crc_t;
+
+/**
+ * @brief List of priorities used to share a port between IDs.
+ * @note
+ *        Transactions from IDs on the same port wait in a queue of up to
+ *        SPI_MAX_QUEUED_TRANSACTIONS entries and run one at a time, highest
+ *        priority first and in order of arrival within a priority. A running
+ *        transaction is not interrupted, so a high priority one waits at most
+ *        for the transaction in progress, or for the whole window of a port
+ *        lock taken with SPI_LockPort. The port registers are rewritten
+ *        only when the next ID uses a different mode or clock frequency.
+ *        An ID with SPI_SOFTWARE_CS must hold the port with SPI_LockPort
+ *        while its CS is asserted; the lock is arbitrated the same way, so
+ *        transactions of other IDs never run while two devices are
+ *        selected.
+ */
+typedef enum
+{
+  SPI_PRIORITY_LOW = 0,
+  SPI_PRIORITY_NORMAL,
+  SPI_PRIORITY_HIGH,
+  SPI_NUMBER_OF_PRIORITIES,
+} SPI_Priority_t;
+
+/**
+ * @brief List of roles on the bus.
+ * @note  With SPI_SLAVE the clock comes from the host, up to 21 MHz, and
+ *        ClockFrequency is ignored. CsMode must be SPI_HARDWARE_CS: the NSS
+ *        input is the hardware NSS pin of the port, PA4 for SPI1, PB12 for
+ *        SPI2 and PA15 for SPI3, active low. It is used as alternate
+ *        function, so the port only drives MISO and shifts bits while
+ *        selected and can share the bus with other slaves, and its EXTI
+ *        line reports the edges; an error is returned if that EXTI line is
+ *        already used by another pin. MosiValueOnReads is the value sent
+ *        when no data was queued.
+ */
+typedef enum
+{
+  SPI_MASTER = 0,
+  SPI_SLAVE,
+  SPI_NUMBER_OF_ROLES,
+} SPI_Role_t;
+
+/**
+ * @brief List of events reported in slave mode.
+ */
+typedef enum
+{
+  SPI_EVENT_SELECTED = 0, /*!< NSS asserted, a frame starts */
+  SPI_EVENT_DESELECTED,   /*!< NSS released, the frame ended */
+  SPI_EVENT_HALF_RING,    /*!< Reception reached the middle of the ring */
+  SPI_EVENT_FULL_RING,    /*!< Reception reached the end of the ring */
+  SPI_EVENT_OVERRUN,      /*!< Unread data was overwritten */
+  SPI_EVENT_UNDERRUN,     /*!< The host clocked more data than was queued */
+  SPI_NUMBER_OF_EVENTS,
+} SPI_Event_t;
+
 /**
  * @brief SPI configuration structure.
  */
@@ -83,8 +184,85 @@ typedef struct
 
   float          ClockFrequency;
   uint8_t        MosiValueOnReads; /*!<Value sent during read operations*/
+
+  SPI_Priority_t Priority;
+
+  SPI_FrameSize_t FrameSize;
+  SPI_Crc_t       Crc;
+  uint16_t        CrcPolynomial;
+
+  SPI_Role_t      Role;
 } SPI_Parameters_t;
 
+/**
+ * @brief List of transaction segment types.
+ */
+typedef enum
+{
+  SPI_SEGMENT_SEND = 0, /*!< Sends SendBuffer, received data is discarded */
+  SPI_SEGMENT_READ,     /*!< Receives into RecBuffer */
+  SPI_SEGMENT_TRANSFER, /*!< Sends SendBuffer and receives into RecBuffer */
+  SPI_SEGMENT_DUMMY,    /*!< Clocks bytes out, received data is discarded */
+  SPI_SEGMENT_DELAY,    /*!< Waits with the clock stopped */
+  SPI_NUMBER_OF_SEGMENT_TYPES,
+} SPI_SegmentType_t;
+
+/**
+ * @brief Transaction segment structure.
+ * @note  Read and dummy segments send MosiValueOnReads, without a transmit
+ *        buffer, as SPI_Read does.
+ */
+typedef struct
+{
+  SPI_SegmentType_t Type;
+  uint8_t           *SendBuffer;
+  uint8_t           *RecBuffer;
+  uint32_t          Length;      /*!< Bytes, or microseconds for delays */
+} SPI_Segment_t;
+
+/**
+ * @brief Routine called by the driver when an asynchronous transfer ends.
+ * @note  It runs in interrupt context.
+ */
+typedef void (*SPI_Callback_t)(uint8_t ID, EStatus_t Status);
+
+/**
+ * @brief Memory region given as a pointer and a length in bytes.
+ */
+typedef struct
+{
+  uint8_t  *Data;
+  uint32_t Length;
+} SPI_Buffer_t;
+
+/**
+ * @brief Routine called by the driver to report a slave mode event.
+ * @note  It runs in interrupt context and should only flag the event.
+ */
+typedef void (*SPI_EventCallback_t)(uint8_t ID, SPI_Event_t Event);
+
+/**
+ * @brief Counters of an SPI ID.
+ */
+typedef struct
+{
+  uint32_t Transactions;
+  uint32_t MaxQueueDelay_us;   /*!< Longest wait for the port */
+  uint32_t TotalQueueDelay_us;
+  uint32_t BusTime_us;         /*!< Time the ID held the port */
+} SPI_Statistics_t;
+
+/**
+ * @brief Counters of an SPI port.
+ * @note  BusyTime_us / Elapsed_us is the port utilization.
+ */
+typedef struct
+{
+  uint32_t Elapsed_us;
+  uint32_t BusyTime_us;
+  uint32_t Reconfigurations;   /*!< Times the port registers were rewritten */
+} SPI_PortStatistics_t;
+
 
 
 /**
@@ -116,6 +294,10 @@ EStatus_t SPI_Send(uint8_t ID, uint8_t *SendBuffer, uint16_t SendLength);
  * @note
  *         The MosiValueOnReads configured during the SPI_Init call will be
  *         sent through MOSI pin.
+ *         The transmit DMA stream reads MosiValueOnReads from a single byte
+ *         with memory increment disabled, so no transmit buffer is filled or
+ *         allocated, whatever RecLength is. In 16 bits frames the value is
+ *         sent in both bytes.
  */
 EStatus_t SPI_Read(uint8_t ID, uint8_t *RecBuffer, uint16_t RecLength);
 
@@ -131,4 +313,237 @@ EStatus_t SPI_Read(uint8_t ID, uint8_t *RecBuffer, uint16_t RecLength);
 EStatus_t SPI_Transfer(uint8_t ID, uint8_t *SendBuffer, uint8_t *RecBuffer,
     uint16_t Length);
 
+
+/**
+ * @brief  Routine that starts sending data to SPI.
+ * @param  ID : SPI ID number.
+ * @param  SendBuffer : Pointer to where the data is.
+ * @param  SendLength : How many bytes to send.
+ * @param  Callback : Routine called when the transfer ends, can be NULL.
+ * @retval EStatus_t
+ * @note
+ *         The transfer runs on the DMA streams of the port and the routine
+ *         returns right away. Lengths above 65535 bytes, the limit of a DMA
+ *         transfer, are split into chained transfers by the driver. The
+ *         buffer must not change until the transfer ends, which is reported
+ *         by Callback and by SPI_GetStatus.
+ */
+EStatus_t SPI_SendAsync(uint8_t ID, uint8_t *SendBuffer, uint32_t SendLength,
+    SPI_Callback_t Callback);
+
+
+/**
+ * @brief  Routine that starts reading data from SPI.
+ * @param  ID : SPI ID number.
+ * @param  RecBuffer : Pointer to store the received data.
+ * @param  RecLength : How many bytes to receive.
+ * @param  Callback : Routine called when the transfer ends, can be NULL.
+ * @retval EStatus_t
+ * @note   Works as SPI_SendAsync, sending MosiValueOnReads as SPI_Read does.
+ */
+EStatus_t SPI_ReadAsync(uint8_t ID, uint8_t *RecBuffer, uint32_t RecLength,
+    SPI_Callback_t Callback);
+
+
+/**
+ * @brief  Routine that starts sending and reading data from SPI.
+ * @param  ID : SPI ID number.
+ * @param  SendBuffer : Pointer to where the data is.
+ * @param  RecBuffer : Pointer to store the received data.
+ * @param  Length : How many bytes to transfer.
+ * @param  Callback : Routine called when the transfer ends, can be NULL.
+ * @retval EStatus_t
+ * @note   Works as SPI_SendAsync.
+ */
+EStatus_t SPI_TransferAsync(uint8_t ID, uint8_t *SendBuffer,
+    uint8_t *RecBuffer, uint32_t Length, SPI_Callback_t Callback);
+
+
+/**
+ * @brief  Routine that checks if an asynchronous transfer has ended.
+ * @param  ID : SPI ID number.
+ * @retval Result : Result of Operation.
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The last transfer ended successfully.
+ *         @arg OPERATION_RUNNING: The transfer is still running.
+ *         @arg Else: Some error happened.
+ */
+EStatus_t SPI_GetStatus(uint8_t ID);
+
+
+/**
+ * @brief  Routine that runs a list of segments under one CS assertion.
+ * @param  ID : SPI ID number.
+ * @param  Segments : Array with the segments to run, in order.
+ * @param  NumberOfSegments : How many segments Segments holds.
+ * @param  Callback : Routine called when the last segment ends, can be NULL.
+ * @retval EStatus_t
+ * @note
+ *         With SPI_HARDWARE_CS the CS pin is asserted before the first
+ *         segment and released after the last one; with SPI_SOFTWARE_CS the
+ *         caller keeps it asserted around the call, between SPI_LockPort and
+ *         SPI_UnlockPort. The port is set up once
+ *         and each segment is started by the DMA completion interrupt of the
+ *         previous one, so the routine returns right away. Segments and the
+ *         buffers must not change until the end is reported by Callback and
+ *         by SPI_GetStatus.
+ */
+EStatus_t SPI_Execute(uint8_t ID, SPI_Segment_t *Segments,
+    uint8_t NumberOfSegments, SPI_Callback_t Callback);
+
+
+/**
+ * @brief  Routine that takes the port for an ID with SPI_SOFTWARE_CS.
+ * @param  ID : SPI ID number.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The port belongs to the ID.
+ *         @arg OPERATION_RUNNING: The request waits in the port queue.
+ *         @arg Else: Some error happened.
+ * @note   The request is queued like a transaction, with the priority of
+ *         the ID, and the routine must be called again until it returns
+ *         ANSWERED_REQUEST; only then may the caller assert its CS. While
+ *         the port is locked only transactions of this ID run on it. An ID
+ *         alone on its port gets the port on the first call.
+ */
+EStatus_t SPI_LockPort(uint8_t ID);
+
+
+/**
+ * @brief  Routine that gives back the port taken with SPI_LockPort.
+ * @param  ID : SPI ID number.
+ * @retval EStatus_t
+ * @note   The caller must release its CS before calling it.
+ */
+EStatus_t SPI_UnlockPort(uint8_t ID);
+
+
+/**
+ * @brief  This routine returns the counters of an SPI ID.
+ * @param  ID : SPI ID number.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t SPI_GetStatistics(uint8_t ID, SPI_Statistics_t *Statistics);
+
+
+/**
+ * @brief  This routine resets the counters of an SPI ID.
+ * @param  ID : SPI ID number.
+ * @retval EStatus_t
+ * @note   As with UART_ClearStatistics, Transactions, TotalQueueDelay_us
+ *         and BusTime_us, written by the interrupt, are kept and a baseline
+ *         is subtracted from them. MaxQueueDelay_us is a maximum, so a reset
+ *         flag is set instead: the interrupt stores the next queue delay as
+ *         new maximum and clears the flag, and MaxQueueDelay_us reads zero
+ *         until then.
+ */
+EStatus_t SPI_ClearStatistics(uint8_t ID);
+
+
+/**
+ * @brief  This routine returns the counters of an SPI port.
+ * @param  Port : SPI port.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t SPI_GetPortStatistics(SPI_Port_t Port,
+    SPI_PortStatistics_t *Statistics);
+
+
+/**
+ * @brief  This routine resets the counters of an SPI port.
+ * @param  Port : SPI port.
+ * @retval EStatus_t
+ */
+EStatus_t SPI_ClearPortStatistics(SPI_Port_t Port);
+
+
+/**
+ * @brief  Routine that changes the clock frequency of an SPI ID.
+ * @param  ID : SPI ID number.
+ * @param  ClockFrequency : The desired clock frequency in Hz.
+ * @retval EStatus_t
+ * @note   The fastest clock not above ClockFrequency is used. Only the
+ *         setting kept for the ID is changed, the port is not torn down. It
+ *         is applied from the next transaction of the ID on, the ones already
+ *         queued or running keep the previous clock.
+ */
+EStatus_t SPI_SetClockFrequency(uint8_t ID, float ClockFrequency);
+
+
+/**
+ * @brief  Routine that changes the value sent during read operations.
+ * @param  ID : SPI ID number.
+ * @param  MosiValueOnReads : Value sent through MOSI pin on reads.
+ * @retval EStatus_t
+ * @note   It is applied from the next transaction of the ID on.
+ */
+EStatus_t SPI_SetMosiValueOnReads(uint8_t ID, uint8_t MosiValueOnReads);
+
+
+/**
+ * @brief  Starts slave mode operation with reception and transmission rings.
+ * @param  ID : SPI ID number, configured with SPI_SLAVE role.
+ * @param  RecRing : Pointer to the memory used as reception ring.
+ * @param  RecRingSize : Size of the reception ring in bytes.
+ * @param  SendRing : Pointer to the memory used as transmission ring.
+ * @param  SendRingSize : Size of the transmission ring in bytes.
+ * @param  Callback : Routine called on every slave mode event, can be NULL.
+ * @retval EStatus_t
+ * @note
+ *         Both DMA streams of the port run in circular mode, so no interrupt
+ *         is taken per byte. Received data is read with SPI_PeekRing and
+ *         freed with SPI_ReleaseRing; data to send is written ahead of the
+ *         host clock with SPI_QueueSend. NSS edges are reported as
+ *         SPI_EVENT_SELECTED and SPI_EVENT_DESELECTED, which frame the data.
+ */
+EStatus_t SPI_StartSlave(uint8_t ID, uint8_t *RecRing, uint32_t RecRingSize,
+    uint8_t *SendRing, uint32_t SendRingSize, SPI_EventCallback_t Callback);
+
+
+/**
+ * @brief  Gives access to the unread data of the reception ring.
+ * @param  ID : SPI ID number.
+ * @param  First : Region holding the oldest unread bytes.
+ * @param  Second : Region holding the bytes written after the ring wrapped
+ *         around, its Length is zero if the ring did not wrap.
+ * @retval EStatus_t
+ * @note   The regions point straight into the ring and stay valid until
+ *         released with SPI_ReleaseRing. OPERATION_RUNNING is returned while
+ *         the ring is empty.
+ */
+EStatus_t SPI_PeekRing(uint8_t ID, SPI_Buffer_t *First, SPI_Buffer_t *Second);
+
+
+/**
+ * @brief  Frees bytes of the reception ring after they were processed.
+ * @param  ID : SPI ID number.
+ * @param  Length : How many bytes, starting at the oldest one, to free.
+ * @retval EStatus_t
+ */
+EStatus_t SPI_ReleaseRing(uint8_t ID, uint32_t Length);
+
+
+/**
+ * @brief  Copies data into the transmission ring, to be sent the next time
+ *         the host clocks the bus.
+ * @param  ID : SPI ID number.
+ * @param  SendBuffer : Pointer to where the data is.
+ * @param  SendLength : How many bytes to queue.
+ * @retval EStatus_t
+ * @note   An error is returned, and nothing is queued, if the ring does not
+ *         have room for SendLength bytes. Positions already sent are filled
+ *         with MosiValueOnReads, which is what the host reads on an underrun.
+ */
+EStatus_t SPI_QueueSend(uint8_t ID, uint8_t *SendBuffer, uint32_t SendLength);
+
+
+/**
+ * @brief  Stops the slave mode operation started by SPI_StartSlave.
+ * @param  ID : SPI ID number.
+ * @retval EStatus_t
+ */
+EStatus_t SPI_StopSlave(uint8_t ID);
+
 #endif /* SPI_H */
@@ -0,0 +1,162 @@
+/**
+ * @file  framing.h
+ * @date  17-October-2026
+ * @brief Streaming COBS and SLIP framing over UART IDs.
+ *
+ * Frames are decoded byte by byte straight from the UART reception ring into
+ * a single frame buffer per framing ID, so received data is never stored
+ * twice, and every complete frame is reported through a callback.
+ *
+ * @author
+ * @author
+ */
+
+
+#ifndef FRAMING_H
+#define FRAMING_H
+
+
+#include <stdint.h>
+#include "stdstatus.h"
+#include "setup.h"
+#include "uart.h"
+
+
+/**
+ * @brief Maximum number of framing IDs, which limits the maximum number of
+ * UART IDs that can be framed at once. FRAMING_MAX_ID can be changed by
+ * defining it on setup.h file.
+ */
+#ifndef FRAMING_MAX_ID
+#define FRAMING_MAX_ID                                                         1
+#endif
+
+
+/**
+ * @brief Worst case size, delimiter included, of an encoded frame.
+ * @note  Length must account for the CRC32 trailer when it is enabled.
+ */
+#define FRAMING_COBS_MAX_ENCODED_SIZE(Length)  ((Length) + ((Length) / 254) + 2)
+#define FRAMING_SLIP_MAX_ENCODED_SIZE(Length)  (2 * (Length) + 2)
+
+/**
+ * @brief Size of the CRC32 trailer.
+ */
+#define FRAMING_CRC32_SIZE                                                     4
+
+
+/**
+ * @brief List of encodings.
+ */
+typedef enum
+{
+  FRAMING_COBS = 0,  /*!< Consistent Overhead Byte Stuffing, 0x00 delimiter */
+  FRAMING_SLIP,      /*!< RFC 1055, 0xC0 delimiter */
+  FRAMING_NUMBER_OF_ENCODINGS,
+} FRAMING_Encoding_t;
+
+/**
+ * @brief List of integrity check options.
+ */
+typedef enum
+{
+  FRAMING_NO_CRC = 0,
+  FRAMING_CRC32,     /*!< IEEE 802.3 CRC32 appended, little endian */
+  FRAMING_NUMBER_OF_CRC_OPTIONS,
+} FRAMING_Crc_t;
+
+/**
+ * @brief Routine called when a complete frame was decoded.
+ * @note  Frame points to the frame buffer of the ID and is only valid until
+ *        the routine returns. The CRC32 trailer is not included in Length.
+ */
+typedef void (*FRAMING_FrameCallback_t)(uint8_t ID, uint8_t *Frame,
+    uint32_t Length);
+
+/**
+ * @brief Framing configuration structure.
+ */
+typedef struct
+{
+  uint8_t                 UartID;        /*!< UART ID, already initialized */
+  FRAMING_Encoding_t      Encoding;
+  FRAMING_Crc_t           Crc;
+  uint8_t                 *RingBuffer;   /*!< UART reception ring */
+  uint32_t                RingSize;
+  uint8_t                 *RecBuffer;    /*!< Stores the frame being decoded */
+  uint32_t                RecBufferSize;
+  uint8_t                 *SendBuffer;   /*!< Stores the frame being sent */
+  uint32_t                SendBufferSize;
+  FRAMING_FrameCallback_t Callback;
+} FRAMING_Parameters_t;
+
+/**
+ * @brief Framing counters.
+ */
+typedef struct
+{
+  uint32_t Frames;          /*!< Frames reported through the callback */
+  uint32_t CrcErrors;       /*!< Frames dropped due to a bad CRC32 */
+  uint32_t Overflows;       /*!< Frames dropped for not fitting RecBuffer */
+  uint32_t EncodingErrors;  /*!< Frames dropped due to invalid encoding */
+} FRAMING_Statistics_t;
+
+
+/**
+ * @brief  Framing configuration routine.
+ * @param  ID : ID that should be allocated and configured.
+ * @param  Parameter : The desired framing parameters.
+ * @retval EStatus_t
+ * @note   The UART ID is put in ring reception mode, through
+ *         UART_StartRingReception, on RingBuffer, which must stay valid
+ *         while the ID is used. If RingBuffer is NULL the UART ID must
+ *         already be in ring reception mode, started by the caller, and
+ *         RingSize is ignored.
+ */
+EStatus_t FRAMING_Init(uint8_t ID, FRAMING_Parameters_t Parameter);
+
+
+/**
+ * @brief  Framing processing routine, to be called from the main loop.
+ * @param  ID : Framing ID number.
+ * @retval EStatus_t
+ * @note   Every byte waiting in the reception ring is decoded and released.
+ *         The callback is called from this routine, once per frame.
+ */
+EStatus_t FRAMING_Poll(uint8_t ID);
+
+
+/**
+ * @brief  Routine to decode bytes that did not come from the UART ID.
+ * @param  ID : Framing ID number.
+ * @param  Data : Pointer to where the data is.
+ * @param  Length : How many bytes to decode.
+ * @retval EStatus_t
+ * @note   Frames can be split across any number of calls.
+ */
+EStatus_t FRAMING_Decode(uint8_t ID, uint8_t *Data, uint32_t Length);
+
+
+/**
+ * @brief  Routine to encode and send a frame.
+ * @param  ID : Framing ID number.
+ * @param  SendBuffer : Pointer to where the frame is.
+ * @param  SendLength : How many bytes the frame has.
+ * @retval EStatus_t
+ * @note   The frame is encoded, with the CRC32 computed on the fly, into
+ *         the SendBuffer given on FRAMING_Init, and queued with
+ *         UART_SendVector. OPERATION_RUNNING is returned while the previous
+ *         frame is still being sent.
+ */
+EStatus_t FRAMING_Send(uint8_t ID, uint8_t *SendBuffer, uint32_t SendLength);
+
+
+/**
+ * @brief  This routine returns the framing counters.
+ * @param  ID : Framing ID number.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t FRAMING_GetStatistics(uint8_t ID, FRAMING_Statistics_t *Statistics);
+
+#endif  /* FRAMING_H */
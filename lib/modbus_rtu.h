@@ -0,0 +1,88 @@
+/**
+ * @file  modbus_rtu.h
+ * @date  17-October-2026
+ * @brief Definitions shared by the MODBUS RTU server and master.
+ *
+ * @author
+ * @author
+ */
+
+
+#ifndef MODBUS_RTU_H
+#define MODBUS_RTU_H
+
+
+#include <stdint.h>
+#include "stdstatus.h"
+#include "uart.h"
+
+
+/**
+ * @brief Maximum size of a RTU frame (address, PDU and CRC).
+ */
+#define MODBUS_RTU_MAX_FRAME_SIZE                                            256
+
+/**
+ * @brief Address used by the master to talk to every server at once.
+ */
+#define MODBUS_RTU_BROADCAST_ADDRESS                                           0
+
+/**
+ * @brief Initial value of the CRC16 computed by MODBUS_RTU_Crc16.
+ */
+#define MODBUS_RTU_CRC16_INIT                                             0xFFFF
+
+
+/**
+ * @brief List of supported function codes.
+ */
+typedef enum
+{
+  MODBUS_READ_COILS                = 0x01,
+  MODBUS_READ_DISCRETE_INPUTS      = 0x02,
+  MODBUS_READ_HOLDING_REGISTERS    = 0x03,
+  MODBUS_READ_INPUT_REGISTERS      = 0x04,
+  MODBUS_WRITE_SINGLE_COIL         = 0x05,
+  MODBUS_WRITE_SINGLE_REGISTER     = 0x06,
+  MODBUS_WRITE_MULTIPLE_COILS      = 0x0F,
+  MODBUS_WRITE_MULTIPLE_REGISTERS  = 0x10,
+} MODBUS_FunctionCode_t;
+
+/**
+ * @brief List of exception codes sent back on errors.
+ */
+typedef enum
+{
+  MODBUS_ILLEGAL_FUNCTION          = 0x01,
+  MODBUS_ILLEGAL_DATA_ADDRESS      = 0x02,
+  MODBUS_ILLEGAL_DATA_VALUE        = 0x03,
+  MODBUS_SERVER_DEVICE_FAILURE     = 0x04,
+} MODBUS_Exception_t;
+
+
+/**
+ * @brief  Routine to compute the CRC16 of a frame.
+ * @param  Crc : MODBUS_RTU_CRC16_INIT, or the value returned for the
+ *         previous part of the frame.
+ * @param  Buffer : Pointer to where the data is.
+ * @param  Length : How many bytes to process.
+ * @retval The CRC16, to be sent low byte first.
+ * @note   It is table driven and processes two bytes per iteration
+ *         (slice-by-2). Running it over a whole frame, CRC included, returns
+ *         zero when the frame is intact.
+ */
+uint16_t MODBUS_RTU_Crc16(uint16_t Crc, const uint8_t *Buffer,
+    uint32_t Length);
+
+
+/**
+ * @brief  Routine that returns the silent interval between frames.
+ * @param  BaudRate : The baud rate used on the bus.
+ * @retval The time of 3.5 characters (11 bits each) in microseconds.
+ * @note   The exact interval is used for every baud rate, instead of the
+ *         fixed 1750 us allowed above 19200 bps, because frame ends are
+ *         timestamped by the UART idle-line event rather than by polling.
+ */
+uint32_t MODBUS_RTU_GetFrameGap(UART_BaudRate_t BaudRate);
+
+#endif /* MODBUS_RTU_H */
@@ -0,0 +1,155 @@
+/**
+ * @file  modbus_rtu_master.h
+ * @date  17-October-2026
+ * @brief MODBUS RTU master configuration and access.
+ *
+ * The master goes through a poll table, sending each entry to its slave
+ * when its period expires. Entries for the same slave, function and period
+ * with adjacent address ranges are merged into a single request. Read
+ * request frames are built once, during MODBUS_RTU_MASTER_Init, in
+ * preallocated buffers; write request frames carry the current values of
+ * Data, so they are encoded again, CRC included, each time they are due.
+ *
+ * @author
+ * @author
+ */
+
+
+#ifndef MODBUS_RTU_MASTER_H
+#define MODBUS_RTU_MASTER_H
+
+
+#include <stdint.h>
+#include "stdstatus.h"
+#include "setup.h"
+#include "uart.h"
+#include "modbus_rtu.h"
+
+
+/**
+ * @brief Maximum number of entries of the poll table.
+ * MODBUS_RTU_MASTER_MAX_POLLS can be changed by defining it on setup.h file.
+ */
+#ifndef MODBUS_RTU_MASTER_MAX_POLLS
+#define MODBUS_RTU_MASTER_MAX_POLLS                                           32
+#endif
+
+/**
+ * @brief Maximum number of different slaves with latency statistics.
+ * MODBUS_RTU_MASTER_MAX_SLAVES can be changed by defining it on setup.h file.
+ */
+#ifndef MODBUS_RTU_MASTER_MAX_SLAVES
+#define MODBUS_RTU_MASTER_MAX_SLAVES                                          16
+#endif
+
+
+/**
+ * @brief Master configuration structure.
+ */
+typedef struct
+{
+  uint8_t         UartID;              /*!< UART ID allocated to the master */
+  UART_Port_t     Port;
+  UART_BaudRate_t BaudRate;
+  uint8_t         PitID;               /*!< PIT ID allocated to the master */
+  uint32_t        ResponseTimeOut_ms;  /*!< Time a slave has to answer */
+  uint32_t        TurnaroundDelay_ms;  /*!< Silence after a broadcast */
+} MODBUS_RTU_MASTER_Parameters_t;
+
+/**
+ * @brief Poll table entry.
+ */
+typedef struct
+{
+  uint8_t               SlaveAddress;  /*!< 0 for a broadcast write */
+  MODBUS_FunctionCode_t Function;
+  uint16_t              Address;     /*!< First register or bit */
+  uint16_t              Quantity;    /*!< Number of registers or bits */
+  uint32_t              Period_ms;   /*!< Time between two polls */
+  uint16_t              *Data;       /*!< Values read, or values to write */
+  EStatus_t             Status;      /*!< Result of the last poll */
+} MODBUS_RTU_MASTER_Poll_t;
+
+/**
+ * @brief Latency counters of one slave.
+ */
+typedef struct
+{
+  uint32_t Requests;
+  uint32_t Timeouts;
+  uint32_t Exceptions;
+  uint32_t CrcErrors;
+  uint32_t LastLatency_us;  /*!< From end of request to end of answer */
+  uint32_t MaxLatency_us;
+} MODBUS_RTU_MASTER_SlaveStatistics_t;
+
+/**
+ * @brief Poll cycle counters.
+ */
+typedef struct
+{
+  uint32_t Cycles;          /*!< Times every entry of the table was polled */
+  uint32_t LastCycle_us;
+  uint32_t MaxCycle_us;
+  uint32_t BusyTime_us;     /*!< Time the bus spent with a request pending */
+} MODBUS_RTU_MASTER_Statistics_t;
+
+
+/**
+ * @brief  Master configuration routine.
+ * @param  Parameter : The desired master parameters.
+ * @param  Table : The poll table, which must stay valid while the master runs.
+ * @param  TableSize : Number of entries in Table.
+ * @retval EStatus_t
+ * @note
+ *         Bits of coils and discrete inputs are packed in Data sixteen per
+ *         word, least significant bit first.
+ *         Read entries (function codes 1 to 4) whose ranges are adjacent are
+ *         merged up to the limit of one frame, write entries are never merged.
+ *         Entries with SlaveAddress 0 are broadcasts, which only write
+ *         function codes may use; an error is returned for a broadcast read.
+ *         Only read entries get their request frame built here. Write
+ *         entries (function codes 5, 6, 15 and 16) are encoded from Data and
+ *         their CRC computed again by MODBUS_RTU_MASTER_Run every time they
+ *         are sent, so values changed in Data are always the ones written.
+ */
+EStatus_t MODBUS_RTU_MASTER_Init(MODBUS_RTU_MASTER_Parameters_t Parameter,
+    MODBUS_RTU_MASTER_Poll_t *Table, uint8_t TableSize);
+
+
+/**
+ * @brief  Master processing routine, to be called from the main loop.
+ * @retval EStatus_t
+ * @note   This routine never blocks. It checks the answer of the pending
+ *         request with UART_PeekRing and the time out with PIT_Get, and sends
+ *         the next due request as soon as the bus is released, so the bus
+ *         stays busy while the caller does other work.
+ *         The bus is released MODBUS_RTU_GetFrameGap(BaudRate) after the
+ *         last byte of the answer, or after the time out expired, so the 3.5
+ *         character silence between frames is kept as on the server side.
+ *         A broadcast gets no answer: its Status is set once the frame is
+ *         sent, and the bus is released only after TurnaroundDelay_ms, so
+ *         the slaves can carry out the write before the next request.
+ */
+EStatus_t MODBUS_RTU_MASTER_Run(void);
+
+
+/**
+ * @brief  This routine returns the poll cycle counters.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t MODBUS_RTU_MASTER_GetStatistics(
+    MODBUS_RTU_MASTER_Statistics_t *Statistics);
+
+
+/**
+ * @brief  This routine returns the latency counters of a slave.
+ * @param  SlaveAddress : Address of the slave.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t MODBUS_RTU_MASTER_GetSlaveStatistics(uint8_t SlaveAddress,
+    MODBUS_RTU_MASTER_SlaveStatistics_t *Statistics);
+
+#endif  /* MODBUS_RTU_MASTER_H */
@@ -0,0 +1,115 @@
+/**
+ * @file  modbus_rtu_server.h
+ * @date  17-October-2026
+ * @brief MODBUS RTU server configuration and access.
+ *
+ * The server answers function codes 1 to 6, 15 and 16 using the UART and
+ * port parameters defined on setup.h (MODBUS_RTU_SERVER_*). The four
+ * register maps are flat arrays indexed by the MODBUS address, so every
+ * request is served without searching.
+ *
+ * @author
+ * @author
+ */
+
+
+#ifndef MODBUS_RTU_SERVER_H
+#define MODBUS_RTU_SERVER_H
+
+
+#include <stdint.h>
+#include "stdstatus.h"
+#include "setup.h"
+#include "modbus_rtu.h"
+
+
+/**
+ * @brief Number of bytes used by the bit maps (coils and discrete inputs).
+ * @note  Addresses go from 0 to the *_SIZE values of setup.h, both included,
+ *        so every map holds *_SIZE + 1 entries.
+ */
+#define MODBUS_RTU_SERVER_OUTPUT_COILS_BYTES                                   \
+  ((MODBUS_RTU_SERVER_OUTPUT_COILS_SIZE + 1 + 7) / 8)
+#define MODBUS_RTU_SERVER_DISCRETE_INPUTS_BYTES                                \
+  ((MODBUS_RTU_SERVER_DISCRETE_INPUTS_SIZE + 1 + 7) / 8)
+
+
+/**
+ * @brief Server register maps.
+ * @note  Coils and discrete inputs are packed eight per byte, least
+ *        significant bit first, the same order used inside MODBUS frames.
+ */
+extern uint16_t MODBUS_RTU_SERVER_HoldingRegisters[
+    MODBUS_RTU_SERVER_HOLDING_REGISTERS_SIZE + 1];
+extern uint16_t MODBUS_RTU_SERVER_InputRegisters[
+    MODBUS_RTU_SERVER_INPUT_REGISTERS_SIZE + 1];
+extern uint8_t  MODBUS_RTU_SERVER_OutputCoils[
+    MODBUS_RTU_SERVER_OUTPUT_COILS_BYTES];
+extern uint8_t  MODBUS_RTU_SERVER_DiscreteInputs[
+    MODBUS_RTU_SERVER_DISCRETE_INPUTS_BYTES];
+
+
+/**
+ * @brief Routine called after a write request changed a register map.
+ * @note  Address and Quantity refer to the map written by Function.
+ */
+typedef void (*MODBUS_RTU_SERVER_WriteCallback_t)(
+    MODBUS_FunctionCode_t Function, uint16_t Address, uint16_t Quantity);
+
+/**
+ * @brief Server counters.
+ */
+typedef struct
+{
+  uint32_t Requests;           /*!< Frames addressed to this server */
+  uint32_t Exceptions;         /*!< Requests answered with an exception */
+  uint32_t CrcErrors;          /*!< Frames discarded due to a bad CRC */
+  uint32_t LastTurnaround_us;  /*!< From end of request to start of answer,
+                                    never below MODBUS_RTU_GetFrameGap */
+  uint32_t MaxTurnaround_us;
+} MODBUS_RTU_SERVER_Statistics_t;
+
+
+/**
+ * @brief  Server configuration routine.
+ * @param  Callback : Routine called after each write request, can be NULL.
+ * @retval EStatus_t
+ * @note   The UART ID MODBUS_RTU_SERVER_UART_ID is configured with
+ *         MODBUS_RTU_SERVER_UART_PORT and MODBUS_RTU_SERVER_UART_BAUDRATE and
+ *         put in ring reception mode.
+ */
+EStatus_t MODBUS_RTU_SERVER_Init(MODBUS_RTU_SERVER_WriteCallback_t Callback);
+
+
+/**
+ * @brief  Server processing routine, to be called from the main loop.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: A request was processed.
+ *         @arg OPERATION_RUNNING: No complete frame is waiting.
+ *         @arg Else: Some error happened.
+ * @note   The end of a frame is taken from the timestamp (PIT_GetMicroseconds)
+ *         of the UART idle-line event. A frame is processed as soon as its
+ *         length, known from the function code, is complete and the CRC
+ *         matches; otherwise it is only dropped once the line has been silent
+ *         for MODBUS_RTU_GetFrameGap. The answer is built in a preallocated
+ *         frame buffer, but it is not queued with UART_SendVector before
+ *         MODBUS_RTU_GetFrameGap(MODBUS_RTU_SERVER_UART_BAUDRATE) has elapsed
+ *         since the last request byte, so the 3.5 character silence between
+ *         frames is always kept (about 334 us at 115200 bps).
+ *         Write requests sent to the broadcast address 0 are executed, and
+ *         the callback called, but never answered; read requests sent to it
+ *         are dropped.
+ */
+EStatus_t MODBUS_RTU_SERVER_Run(void);
+
+
+/**
+ * @brief  This routine returns the server counters.
+ * @param  Statistics : Pointer to store the counters.
+ * @retval EStatus_t
+ */
+EStatus_t MODBUS_RTU_SERVER_GetStatistics(
+    MODBUS_RTU_SERVER_Statistics_t *Statistics);
+
+#endif  /* MODBUS_RTU_SERVER_H */
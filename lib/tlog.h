@@ -0,0 +1,188 @@
+/**
+ * @file  tlog.h
+ * @date  17-October-2026
+ * @brief Deferred binary logging (tokenized printf) over a UART ID.
+ *
+ * Log calls do not format text on the target. They store the token of the
+ * format string and the raw arguments in a lock-free ring, which TLOG_Flush
+ * later sends through the UART from a low priority context. A host tool
+ * rebuilds the text from the format strings kept in the .tlog section of the
+ * firmware ELF file.
+ *
+ * Format strings are placed in a section that takes no flash; the linker
+ * script must contain:
+ *   .tlog 0 (INFO) : { __tlog_start = .; KEEP(*(.tlog)) }
+ *
+ * Each record is sent little endian as:
+ *   uint16_t Token          Offset of the format string in .tlog
+ *   uint8_t  NumberOfArgs
+ *   uint8_t  Sequence       Incremented per record, gaps show lost records
+ *   uint32_t Timestamp_us   From PIT_GetMicroseconds
+ *   uint32_t Args[NumberOfArgs]
+ *
+ * @author
+ * @author
+ */
+
+
+#ifndef TLOG_H
+#define TLOG_H
+
+
+#include <stdint.h>
+#ifdef __cplusplus
+#include <type_traits>
+#endif
+#include "stdstatus.h"
+#include "setup.h"
+
+
+/**
+ * @brief Size in bytes of the record ring, must be a power of two.
+ * TLOG_RING_SIZE can be changed by defining it on setup.h file.
+ */
+#ifndef TLOG_RING_SIZE
+#define TLOG_RING_SIZE                                                      1024
+#endif
+
+/**
+ * @brief Maximum number of arguments of a record.
+ */
+#define TLOG_MAX_ARGS                                                          4
+
+
+/**
+ * @brief Records a message without arguments.
+ * @param Format : String literal in printf syntax.
+ */
+#define TLOG(Format)                                                           \
+  do                                                                           \
+  {                                                                            \
+    static const char TLOG_Format[]                                            \
+        __attribute__((section(".tlog"), used)) = Format;                      \
+    TLOG_Record(TLOG_Format, 0, (const uint32_t *)0);                          \
+  } while (0)
+
+/**
+ * @brief Helpers of TLOG_ARGS: TLOG_COUNT gives the number of arguments, up
+ * to 8, and TLOG_WORDS converts each of them to uint32_t through uintptr_t,
+ * so pointers and signed values are accepted by C and C++ alike. TLOG_WORD
+ * only compiles for integers of up to 4 bytes and for 4 bytes pointers, as
+ * told by __builtin_classify_type in C (1 to 4 integer kinds, 5 pointers) and
+ * by the type traits in C++, so a float or a 64 bits integer can not be
+ * truncated silently.
+ */
+#define TLOG_COUNT(...)                                                        \
+  TLOG_COUNT_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TLOG_COUNT_(A1, A2, A3, A4, A5, A6, A7, A8, N, ...)                    N
+#define TLOG_CONCAT(A, B)                                                      \
+  TLOG_CONCAT_(A, B)
+#define TLOG_CONCAT_(A, B)                                                A##B
+#ifdef __cplusplus
+#define TLOG_TYPE(A)                               std::decay<decltype(A)>::type
+#define TLOG_IS_WORD(A)                                                        \
+  (((std::is_integral<TLOG_TYPE(A)>::value ||                                  \
+     std::is_enum<TLOG_TYPE(A)>::value) && sizeof(A) <= 4) ||                  \
+   (std::is_pointer<TLOG_TYPE(A)>::value && sizeof(void *) <= 4))
+#else
+#define TLOG_IS_WORD(A)                                                        \
+  ((__builtin_classify_type(A) >= 1 && __builtin_classify_type(A) <= 4 &&      \
+    sizeof(A) <= 4) ||                                                         \
+   (__builtin_classify_type(A) == 5 && sizeof(void *) <= 4))
+#endif
+#define TLOG_WORD(A)                                                           \
+  ((void)sizeof(char[TLOG_IS_WORD(A) ? 1 : -1]), (uint32_t)(uintptr_t)(A))
+#define TLOG_WORDS(...)                                                        \
+  TLOG_CONCAT(TLOG_WORDS_, TLOG_COUNT(__VA_ARGS__))(__VA_ARGS__)
+#define TLOG_WORDS_1(A)                                           TLOG_WORD(A)
+#define TLOG_WORDS_2(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_1(__VA_ARGS__)
+#define TLOG_WORDS_3(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_2(__VA_ARGS__)
+#define TLOG_WORDS_4(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_3(__VA_ARGS__)
+#define TLOG_WORDS_5(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_4(__VA_ARGS__)
+#define TLOG_WORDS_6(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_5(__VA_ARGS__)
+#define TLOG_WORDS_7(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_6(__VA_ARGS__)
+#define TLOG_WORDS_8(A, ...)                                                   \
+  TLOG_WORD(A), TLOG_WORDS_7(__VA_ARGS__)
+
+/**
+ * @brief Records a message with up to TLOG_MAX_ARGS arguments.
+ * @param Format : String literal in printf syntax.
+ * @note  Arguments are stored as uint32_t; integers of up to 32 bits and
+ *        pointers of 32 bits are supported, the host tool reinterprets them
+ *        following Format. Any other argument, a float or a 64 bits integer
+ *        for instance, does not compile: floats must be passed through
+ *        TLOG_Float, which keeps their bits for %f. A call with more than
+ *        TLOG_MAX_ARGS arguments does not compile either.
+ */
+#define TLOG_ARGS(Format, ...)                                                 \
+  do                                                                           \
+  {                                                                            \
+    static const char TLOG_Format[]                                            \
+        __attribute__((section(".tlog"), used)) = Format;                      \
+    const uint32_t TLOG_Args[] = { TLOG_WORDS(__VA_ARGS__) };                  \
+    (void)sizeof(char[(sizeof(TLOG_Args) / sizeof(TLOG_Args[0]) <=             \
+        TLOG_MAX_ARGS) ? 1 : -1]);                                             \
+    TLOG_Record(TLOG_Format,                                                   \
+        sizeof(TLOG_Args) / sizeof(TLOG_Args[0]), TLOG_Args);                  \
+  } while (0)
+
+
+/**
+ * @brief  Logging configuration routine.
+ * @param  UartID : UART ID, already initialized, used to send the records.
+ * @retval EStatus_t
+ */
+EStatus_t TLOG_Init(uint8_t UartID);
+
+
+/**
+ * @brief  Routine that stores a record, used by TLOG and TLOG_ARGS.
+ * @param  Format : Format string placed in the .tlog section.
+ * @param  NumberOfArgs : How many arguments Args holds.
+ * @param  Args : Pointer to the arguments.
+ * @retval void.
+ * @note   It can be called from any context, interrupts included. Space in
+ *         the ring is reserved with an exclusive load/store loop, so callers
+ *         never wait for each other, and the record is copied word by word,
+ *         in a few tens of cycles. If the ring is full the record is dropped
+ *         and counted.
+ */
+void TLOG_Record(const char *Format, uint32_t NumberOfArgs,
+    const uint32_t *Args);
+
+
+/**
+ * @brief  Routine that sends the stored records, to be called from a low
+ *         priority context such as the main loop idle time.
+ * @retval EStatus_t
+ *         This parameter can be one of the following values:
+ *         @arg ANSWERED_REQUEST: The ring is empty.
+ *         @arg OPERATION_RUNNING: Records are still waiting to be sent.
+ *         @arg Else: Some error happened.
+ * @note   Complete records are sent straight from the ring with
+ *         UART_SendVector, as one or two regions, and freed once sent.
+ */
+EStatus_t TLOG_Flush(void);
+
+
+/**
+ * @brief  Routine that keeps the bits of a float argument of TLOG_ARGS.
+ * @param  Value : The float to log.
+ * @retval The IEEE 754 single precision bits of Value.
+ */
+uint32_t TLOG_Float(float Value);
+
+
+/**
+ * @brief  This routine returns the number of records dropped.
+ * @retval Records dropped for lack of space in the ring.
+ */
+uint32_t TLOG_GetDropped(void);
+
+#endif  /* TLOG_H */
@@ -24,6 +24,7 @@
 
 #define LIB_DISP_PIT_ID                                                        0
 #define LIB_AHRS_PIT_ID                                                        1
+#define IIC_PIT_ID                                                            18
 #define SDCARD_PIT_ID                                                         19
 
 /******************************************************************************/
@@ -31,6 +32,8 @@
 /******************************************************************************/
 #define UART_MAX_ID                                                            1
 
+#define MODBUS_RTU_SERVER_UART_ID                                              0
+
 /******************************************************************************/
 /** Configuring the max number of iic IDs that can be configured              */
 /******************************************************************************/
@@ -63,7 +66,10 @@
 #define USE_SDCARD_CARD_DETECT                                                 0
 
 #define SDCARD_SPI_PORT                         SPI3_SCL_PC10_CIPO_PC11_COPI_PB5
-#define SDCARD_PRESCALER                                       SPI_PRESCALLER_32
+/* Identification runs below 400 kHz (SPI3 clock is 42 MHz), then the clock */
+/* goes to the fastest prescaler allowed by the card, up to the data one     */
+#define SDCARD_PRESCALER                                      SPI_PRESCALLER_128
+#define SDCARD_DATA_PRESCALER                                   SPI_PRESCALLER_2
 #define SDCARD_CS_PORT                                           SPI_GPIO_PORT_D
 #define SDCARD_CS_PIN                                             SPI_GPIO_PIN_0
 #define SDCARD_CS_POLARITY                                        SPI_ACTIVE_LOW
@@ -85,6 +91,8 @@
 #define DEV_SSD1306_PORT                                    IIC3_SDA_PC9_SCL_PA8
 #define DEV_SSD1306_ADDR                                            SSD1306_0x3C
 #define DEV_SSD1306_PULLCFG                                  IIC_PULLUP_DISABLED
+#define DEV_SSD1306_PRIORITY                                    IIC_PRIORITY_LOW
+#define DEV_SSD1306_MAX_CHUNK_SIZE                                            32
 
 
 
@@ -102,6 +110,7 @@
 #define DEV_MPU6050_PORT                                    IIC3_SDA_PC9_SCL_PA8
 #define DEV_MPU6050_ADDR                                            MPU6050_0x68
 #define DEV_MPU6050_PULLCFG                                  IIC_PULLUP_DISABLED
+#define DEV_MPU6050_PRIORITY                                   IIC_PRIORITY_HIGH
 
 /******************************************************************************/
 /** Defining the configuration parameters for QMC5883L magnetometer.          */
@@ -111,6 +120,7 @@
 #define DEV_QMC5883L_PORT                                   IIC3_SDA_PC9_SCL_PA8
 #define DEV_QMC5883L_ADDR                                          QMC5883L_0x0D
 #define DEV_QMC5883L_PULLCFG                                 IIC_PULLUP_DISABLED
+#define DEV_QMC5883L_PRIORITY                                  IIC_PRIORITY_HIGH
 
 /******************************************************************************/
 /** Defining the configuration parameters motor pins (encoders and PWM).      */